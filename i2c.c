@@ -1,15 +1,107 @@
-#include "i2c.h"
+#include "i2c_device.h"
 
-/* 
- * To be implemented by the device specific source file:
+/*
+ * To be implemented by the core state machine of the device (selected by the device descriptor header, see i2c_device.h):
  *   void SSP1_I2C_slave_init(unsigned char address);
  *   void SSP1_I2C_slave_handle_interrupt(void);
- * 
- * 
+ *
+ *   - i2c_mssp.c: MSSP module (SSP1_I2C_MSSP)
+ *   - i2c_module.c: dedicated I2C module (SSP1_I2C_MODULE)
+ *
+ *
  * To be implemented by the source code using this library:
  *   void SSP1_I2C_slave_begin(unsigned char address);
  *   void SSP1_I2C_slave_read(unsigned char* data, size_t length);
  *   void SSP1_I2C_slave_write(unsigned char* data);
  *   void SSP1_I2C_slave_end(void);
- * 
+ *
  */
+
+#ifdef SSP1_I2C
+unsigned char __SSP1_I2C_slave_null;
+unsigned char __SSP1_I2C_slave_address;
+size_t __SSP1_I2C_slave_buffer_index = 0;
+unsigned char __SSP1_I2C_slave_buffer_data[SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH];
+
+unsigned char SSP1_I2C_slave_dispatch_interrupt(void)
+{
+    unsigned char events = 0;
+    
+    // test the flags first, so that other interrupts do not pay for the status decode of the I2C module
+    while(events < SSP1_I2C_SLAVE_MAX_EVENTS_PER_INTERRUPT && SSP1_I2C_slave_interrupt_pending())
+    {
+        SSP1_I2C_slave_handle_interrupt();
+        ++events;
+    }
+    
+    return events;
+}
+
+#ifdef SSP1_I2C_SLAVE_FLAG_DEFER_END
+volatile unsigned char __SSP1_I2C_slave_end_pending = 0;
+
+void __SSP1_I2C_slave_complete(void)
+{
+    if(__SSP1_I2C_slave_end_pending == 1)
+    {
+        __SSP1_I2C_slave_end_pending = 0;
+        
+        if((__SSP1_I2C_slave_address & 0b1) == 0) // 0: Write (master wrote, slave has read)
+        {
+            // all the bytes have been received, now we trigger the read function
+            SSP1_I2C_slave_read(__SSP1_I2C_slave_buffer_data, __SSP1_I2C_slave_buffer_index);
+        }
+        
+        SSP1_I2C_slave_end();
+    }
+}
+
+void SSP1_I2C_slave_run_deferred(void)
+{
+    // mask the interrupts of the module, so that a new address is not handled while the buffer is in use
+    // (the clock is held after a matching address, until the interrupt is handled, so the master waits)
+    // SSP1_I2C_slave_dispatch_interrupt() only handles enabled interrupts, so other interrupts calling it meanwhile do not either
+    unsigned char ie = SSP1_I2C_IE;
+    SSP1_I2C_IE = 0;
+#ifdef SSP1_I2C_MSSP
+    unsigned char bclie = SSP1_I2C_BCLIE;
+    SSP1_I2C_BCLIE = 0;
+#endif /* SSP1_I2C_MSSP */
+#ifdef SSP1_I2C_MODULE
+    // data bytes and errors have their own interrupts, mask them too (rather than relying on the clock being held after the address)
+    unsigned char eie = SSP1_I2C_EIE;
+    unsigned char rxie = SSP1_I2C_RXIE;
+    unsigned char txie = SSP1_I2C_TXIE;
+    SSP1_I2C_EIE = 0;
+    SSP1_I2C_RXIE = 0;
+    SSP1_I2C_TXIE = 0;
+#endif /* SSP1_I2C_MODULE */
+    
+    __SSP1_I2C_slave_complete();
+    
+#ifdef SSP1_I2C_MODULE
+    SSP1_I2C_TXIE = txie;
+    SSP1_I2C_RXIE = rxie;
+    SSP1_I2C_EIE = eie;
+#endif /* SSP1_I2C_MODULE */
+#ifdef SSP1_I2C_MSSP
+    SSP1_I2C_BCLIE = bclie;
+#endif /* SSP1_I2C_MSSP */
+    SSP1_I2C_IE = ie;
+}
+#endif /* SSP1_I2C_SLAVE_FLAG_DEFER_END */
+#endif /* SSP1_I2C */
+
+#ifdef SSP2_I2C
+unsigned char __SSP2_I2C_slave_null;
+unsigned char __SSP2_I2C_slave_address;
+size_t __SSP2_I2C_slave_buffer_index = 0;
+unsigned char __SSP2_I2C_slave_buffer_data[SSP2_I2C_SLAVE_MAX_BUFFER_LENGTH];
+#endif /* SSP2_I2C */
+
+#ifdef SSP3_I2C
+unsigned char __SSP3_I2C_slave_null;
+unsigned char __SSP3_I2C_slave_address;
+size_t __SSP3_I2C_slave_buffer_index = 0;
+unsigned char __SSP3_I2C_slave_buffer_data[SSP3_I2C_SLAVE_MAX_BUFFER_LENGTH];
+#endif /* SSP3_I2C */
@@ -1,7 +1,12 @@
 #ifndef I2C_H
 #define	I2C_H
 
+#include <stddef.h>
+
+// the registers are provided by <xc.h>, unless another descriptor header was selected (see i2c_device.h)
+#ifndef I2C_DEVICE_HEADER
 #include <xc.h>
+#endif
 
 #ifdef SSP1_I2C
 
@@ -14,10 +19,33 @@
 // #define I2C_SLAVE_FLAG_OVERFLOW_IGNORE        : ignore any additional bytes
 // #define I2C_SLAVE_FLAG_OVERFLOW_OVERWRITE     : overwrite from beginning (without triggering a slave read)
 
-unsigned char __SSP1_I2C_slave_null;
-unsigned char __SSP1_I2C_slave_address;
-size_t __SSP1_I2C_slave_buffer_index = 0;
-unsigned char __SSP1_I2C_slave_buffer_data[SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH];
+// By default, SSP1_I2C_slave_read and SSP1_I2C_slave_end are called from the interrupt upon the stopbit
+// #define SSP1_I2C_SLAVE_FLAG_DEFER_END         : call them from SSP1_I2C_slave_run_deferred() in the main loop instead (must be defined for all source files)
+
+// maximum number of I2C events handled by a single call to SSP1_I2C_slave_dispatch_interrupt()
+#ifndef SSP1_I2C_SLAVE_MAX_EVENTS_PER_INTERRUPT
+#define SSP1_I2C_SLAVE_MAX_EVENTS_PER_INTERRUPT 1
+#endif
+
+// whether any enabled interrupt of the module is pending (a flag is left alone while its interrupt is masked)
+#if defined(SSP1_I2C_MSSP)
+#define SSP1_I2C_slave_interrupt_pending() ((SSP1_I2C_IE == 1 && SSP1_I2C_IF == 1) || (SSP1_I2C_BCLIE == 1 && SSP1_I2C_BCLIF == 1))
+#elif defined(SSP1_I2C_MODULE)
+#define SSP1_I2C_slave_interrupt_pending() ((SSP1_I2C_IE == 1 && SSP1_I2C_IF == 1) || (SSP1_I2C_EIE == 1 && SSP1_I2C_EIF == 1) \
+    || (SSP1_I2C_RXIE == 1 && SSP1_I2C_RXIF == 1) || (SSP1_I2C_TXIE == 1 && SSP1_I2C_TXIF == 1))
+#endif
+
+// slave state (defined in i2c.c, used by the core state machine of the device)
+extern unsigned char __SSP1_I2C_slave_null;
+extern unsigned char __SSP1_I2C_slave_address;
+extern size_t __SSP1_I2C_slave_buffer_index;
+extern unsigned char __SSP1_I2C_slave_buffer_data[SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH];
+#ifdef SSP1_I2C_SLAVE_FLAG_DEFER_END
+extern volatile unsigned char __SSP1_I2C_slave_end_pending;
+
+// call the deferred SSP1_I2C_slave_read and SSP1_I2C_slave_end (used by the core state machine, before a new address is handled)
+void __SSP1_I2C_slave_complete(void);
+#endif /* SSP1_I2C_SLAVE_FLAG_DEFER_END */
 
 // see also pp. 306
 void SSP1_I2C_slave_init(unsigned char address);
@@ -25,6 +53,18 @@ void SSP1_I2C_slave_init(unsigned char address);
 // handle interrupt (must be called from the __interrupt() handler)
 void SSP1_I2C_slave_handle_interrupt(void);
 
+// handle interrupt only if an enabled interrupt of the module is pending, at most SSP1_I2C_SLAVE_MAX_EVENTS_PER_INTERRUPT times
+// (may be called from the __interrupt() handler for any interrupt, returns the number of events handled)
+unsigned char SSP1_I2C_slave_dispatch_interrupt(void);
+
+#ifdef SSP1_I2C_SLAVE_FLAG_DEFER_END
+// call SSP1_I2C_slave_read and SSP1_I2C_slave_end for a completed transmission, if any (must be called from the main loop)
+// Note: the interrupts of the module are masked meanwhile (SSP1_I2C_slave_dispatch_interrupt() leaves them pending),
+// so if the master addresses the slave again, the bus stays stretched
+// until SSP1_I2C_slave_read and SSP1_I2C_slave_end have returned (in exchange, other interrupts are not delayed by them)
+void SSP1_I2C_slave_run_deferred(void);
+#endif /* SSP1_I2C_SLAVE_FLAG_DEFER_END */
+
 
 // interface for start of transmission from master (startbit), after address has been read
 void SSP1_I2C_slave_begin(unsigned char address);
@@ -48,10 +88,10 @@ void SSP1_I2C_slave_end(void);
 #define SSP2_I2C_SLAVE_MAX_BUFFER_LENGTH 256
 #endif
 
-unsigned char __SSP2_I2C_slave_null;
-unsigned char __SSP2_I2C_slave_address;
-size_t __SSP2_I2C_slave_buffer_index = 0;
-unsigned char __SSP2_I2C_slave_buffer_data[I2C_SLAVE_MAX_BUFFER_LENGTH];
+extern unsigned char __SSP2_I2C_slave_null;
+extern unsigned char __SSP2_I2C_slave_address;
+extern size_t __SSP2_I2C_slave_buffer_index;
+extern unsigned char __SSP2_I2C_slave_buffer_data[SSP2_I2C_SLAVE_MAX_BUFFER_LENGTH];
 
 void SSP2_I2C_slave_init(unsigned char address);
 void SSP2_I2C_slave_handle_interrupt(void);
@@ -69,10 +109,10 @@ void SSP2_I2C_slave_end(void);
 #define SSP3_I2C_SLAVE_MAX_BUFFER_LENGTH 256
 #endif
 
-unsigned char __SSP3_I2C_slave_null;
-unsigned char __SSP3_I2C_slave_address;
-size_t __SSP3_I2C_slave_buffer_index = 0;
-unsigned char __SSP3_I2C_slave_buffer_data[I2C_SLAVE_MAX_BUFFER_LENGTH];
+extern unsigned char __SSP3_I2C_slave_null;
+extern unsigned char __SSP3_I2C_slave_address;
+extern size_t __SSP3_I2C_slave_buffer_index;
+extern unsigned char __SSP3_I2C_slave_buffer_data[SSP3_I2C_SLAVE_MAX_BUFFER_LENGTH];
 
 void SSP3_I2C_slave_init(unsigned char address);
 void SSP3_I2C_slave_handle_interrupt(void);
@@ -0,0 +1,32 @@
+// Selects the device descriptor header for the target device (as passed to the compiler with -mcpu)
+// A descriptor header maps the registers of each SSPx/I2Cx module, and indicates which core state machine is used:
+//  - SSPx_I2C_MSSP: MSSP module (i2c_mssp.c)
+//  - SSPx_I2C_MODULE: dedicated I2C module (i2c_module.c)
+//
+// Define I2C_DEVICE_HEADER (e.g. -DI2C_DEVICE_HEADER='"stub_mssp.h"', see test/) to use another descriptor header instead,
+// such as one that maps the registers to plain variables, in order to compile the core state machine on a host (see README.md)
+
+#ifndef I2C_DEVICE_H
+#define	I2C_DEVICE_H
+
+#if defined(I2C_DEVICE_HEADER)
+#include I2C_DEVICE_HEADER
+#else
+
+#include <xc.h>
+
+#if defined(_16F1614)
+#include "i2c_pic16f1614.h"
+#elif defined(_18F27K42)
+#include "i2c_pic18f27k42.h"
+
+// ... add more devices here when necessary ...
+
+#else
+#error "libi2c-pic: no device descriptor header for this device (see i2c_device.h)"
+#endif
+
+#endif /* I2C_DEVICE_HEADER */
+
+
+#endif	/* I2C_DEVICE_H */
@@ -0,0 +1,215 @@
+#include "i2c_device.h"
+
+// Core slave state machine for the dedicated I2C module (PIC18 K-series), compiled against the registers mapped by the device descriptor header
+// (register names are from the I2C module chapter of the PIC18F27K42 datasheet, see i2c_pic18f27k42.h)
+//
+// Compared to the MSSP module, the I2C module has separate receive and transmit buffers (RXB/TXB) with their own interrupt flags.
+// The clock is held by software only after a matching address (to call SSP1_I2C_slave_begin and SSP1_I2C_slave_write).
+// Data bytes still take one interrupt each (RXIF or TXIF), but the next byte to write is loaded into TXB while the previous one
+// is being shifted on the bus, so the hardware only stretches the clock if the interrupt is not handled in time.
+#ifdef SSP1_I2C_MODULE
+
+// Note: address must be within range 8-119 (inclusive)
+void SSP1_I2C_slave_init(unsigned char address)
+{
+    // I2C1CON0 [I2C CONTROL REGISTER 0]
+
+    // I2C Enable bit
+    SSP1_I2C_CON0bits.EN = 0; // 0: Disable the module while configuring
+    // I2C Mode Select bits
+    SSP1_I2C_CON0bits.MODE = 0b000; // I2C Slave mode, 7-bit address
+
+
+    // I2C1ADR0-3 [I2C ADDRESS REGISTERS]
+
+    // Address bits at 1-7, 0th bit is unused and ignored; in 7-bit slave mode all four address registers are matched, so set them all
+    SSP1_I2C_ADR0 = (unsigned char) (address << 1);
+    SSP1_I2C_ADR1 = (unsigned char) (address << 1);
+    SSP1_I2C_ADR2 = (unsigned char) (address << 1);
+    SSP1_I2C_ADR3 = (unsigned char) (address << 1);
+
+
+    // I2C1CON1 [I2C CONTROL REGISTER 1]
+
+    // Acknowledge Data bit
+    SSP1_I2C_CON1bits.ACKDT = 0; // 0: ACK every received byte (while I2C1CNT != 0)
+    // Acknowledge End of Count bit
+    SSP1_I2C_CON1bits.ACKCNT = 0; // 0: ACK every received byte (when I2C1CNT == 0)
+    // Clock Stretching Disable bit
+    SSP1_I2C_CON1bits.CSD = 0; // 0: Slave clock stretching enabled (hardware stretches when RXB is full or TXB is empty)
+
+
+    // I2C1CON2 [I2C CONTROL REGISTER 2]
+
+    // Auto-Load I2C Count Register Enable bit
+    SSP1_I2C_CON2bits.ACNT = 0; // 0: Byte counter is not loaded automatically (it is loaded upon a matching address instead)
+    // SDA Hold Time Selection bits [hint: set to 300ns on buses with large capacitance]
+    SSP1_I2C_CON2bits.SDAHT = 0b00; // 00: Minimum of 300 ns hold time on SDA after the falling edge of SCL
+
+
+    // I2C1PIE [I2C INTERRUPT ENABLE REGISTER]
+
+    SSP1_I2C_PIR = 0; // 0: No interrupt is pending
+    // Address Interrupt and Hold Enable bit
+    SSP1_I2C_PIEbits.ADRIE = 1; // 1: Interrupt on matching address, and hold the clock (CSTR) until it is released
+    // Stop Condition Interrupt Enable bit
+    SSP1_I2C_PIEbits.PCIE = 1; // 1: Enable interrupt on detection of Stop condition
+
+
+    // I2C1ERR [I2C ERROR REGISTER]
+
+    SSP1_I2C_ERR = 0;
+    // Bus Collision Detect Interrupt Enable bit
+    SSP1_I2C_ERRbits.BCLIE = 1; // 1: Enable bus collision interrupts
+
+
+    // I2C1STAT1 [I2C STATUS REGISTER 1]
+
+    // Clear Buffer bit
+    SSP1_I2C_STAT1bits.CLRBF = 1; // 1: Empty RXB and TXB
+
+
+    // PIE3/PIR3 [PERIPHERAL INTERRUPT ENABLE/REQUEST REGISTER 3]
+
+    SSP1_I2C_IF = 0;
+    SSP1_I2C_EIF = 0;
+    SSP1_I2C_IE = 1; // 1: Enables the I2C1 general interrupt (address, stop)
+    SSP1_I2C_EIE = 1; // 1: Enables the I2C1 error interrupt (bus collision)
+    SSP1_I2C_RXIE = 1; // 1: Enables the I2C1 receive buffer interrupt
+    SSP1_I2C_TXIE = 0; // 0: Transmit buffer interrupt is only enabled while the master is reading (TXB is empty most of the time)
+
+
+    // I2C Enable bit
+    SSP1_I2C_CON0bits.EN = 1; // 1: Enables the I2C module
+}
+
+// Slave mode operation (see I2C module chapter, slave mode)
+void SSP1_I2C_slave_handle_interrupt()
+{
+    // I2C1EIF: I2C Error Interrupt Flag bit
+    if(SSP1_I2C_EIF == 1) // 1: Interrupt is pending
+    {
+        // empty the buffers, the module returns to idle by itself
+        SSP1_I2C_STAT1bits.CLRBF = 1;
+
+        // stop writing to master (TXB stays empty, so TXIF would remain set)
+        SSP1_I2C_TXIE = 0;
+
+        // clear the interrupt flags
+        SSP1_I2C_ERRbits.BCLIF = 0;
+        SSP1_I2C_ERRbits.NACKIF = 0;
+    }
+
+    // ADRIF: Address Interrupt Flag bit (clock is held until CSTR is cleared)
+    if(SSP1_I2C_PIRbits.ADRIF == 1)
+    {
+#ifdef SSP1_I2C_SLAVE_FLAG_DEFER_END
+        // the previous transmission was not completed yet by the main loop, do it now (the buffer is about to be reused)
+        __SSP1_I2C_slave_complete();
+#endif /* SSP1_I2C_SLAVE_FLAG_DEFER_END */
+
+        // the address is already matched by the module, otherwise we were not interrupted (0th bit is the R/W bit)
+        __SSP1_I2C_slave_address = SSP1_I2C_ADB0;
+
+        // opportunity to reset the buffer to zero-filled, or do something else upon getting address
+        SSP1_I2C_slave_begin(__SSP1_I2C_slave_address);
+
+        // reset index (for reading or writing buffer data)
+        __SSP1_I2C_slave_buffer_index = 0;
+
+        // I2C1CNT: TXIF is only set while the byte count is not zero, and each byte decrements it
+        SSP1_I2C_CNT = 0xFF;
+
+        if(SSP1_I2C_STAT0bits.R == 1) // 1: Read (master will read, slave will write)
+        {
+            // we need to write, so gather up all the data in advance at this moment
+            SSP1_I2C_slave_write(__SSP1_I2C_slave_buffer_data);
+
+            // discard a byte still prepared from a previous read (master sent NACK and a repeated start), TXB must be empty to load it
+            SSP1_I2C_STAT1bits.CLRBF = 1;
+
+            // prepare the first byte to write to master, the next byte is loaded as soon as TXB is empty again
+            SSP1_I2C_TXB = __SSP1_I2C_slave_buffer_data[__SSP1_I2C_slave_buffer_index++];
+
+            // interrupt whenever TXB is empty again, until the stop bit
+            SSP1_I2C_TXIE = 1;
+        }
+
+        SSP1_I2C_PIRbits.ADRIF = 0;
+
+        // Release the clock line
+        SSP1_I2C_CON0bits.CSTR = 0;
+    }
+
+    // I2C1RXIF: Receive Buffer Full Interrupt Flag bit (cleared by reading RXB)
+    if(SSP1_I2C_RXIF == 1)
+    {
+        // buffer was full already, what are we going to do?
+        if(__SSP1_I2C_slave_buffer_index >= SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH)
+        {
+#ifdef SSP1_I2C_SLAVE_FLAG_OVERFLOW_OVERWRITE
+            __SSP1_I2C_slave_buffer_index = 0;
+#else
+#ifndef SSP1_I2C_SLAVE_FLAG_OVERFLOW_IGNORE
+            // by default, trigger a slave read, when buffer is full, and then start back at zero
+            SSP1_I2C_slave_read(__SSP1_I2C_slave_buffer_data, __SSP1_I2C_slave_buffer_index);
+            __SSP1_I2C_slave_buffer_index = 0;
+#endif /* SSP1_I2C_SLAVE_FLAG_OVERFLOW_IGNORE */
+#endif /* SSP1_I2C_SLAVE_FLAG_OVERFLOW_OVERWRITE */
+        }
+
+        if(__SSP1_I2C_slave_buffer_index < SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH)
+        {
+            // continue reading more bytes into buffer, clearing the RXBF flag
+            __SSP1_I2C_slave_buffer_data[__SSP1_I2C_slave_buffer_index++] = SSP1_I2C_RXB;
+        }
+        else
+        {
+            // read the value to clear the buffer (only when ignoring overflow)
+            __SSP1_I2C_slave_null = SSP1_I2C_RXB;
+        }
+    }
+
+    // I2C1TXIF: Transmit Buffer Empty Interrupt Flag bit (cleared by writing TXB)
+    if(SSP1_I2C_TXIF == 1 && SSP1_I2C_STAT0bits.SMA == 1 && SSP1_I2C_STAT0bits.R == 1)
+    {
+        // the master decides when to stop, so wrap around instead of reading beyond the buffer
+        if(__SSP1_I2C_slave_buffer_index >= SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH)
+        {
+            __SSP1_I2C_slave_buffer_index = 0;
+        }
+
+        // prepare the next byte to write to master
+        SSP1_I2C_TXB = __SSP1_I2C_slave_buffer_data[__SSP1_I2C_slave_buffer_index++];
+
+        // keep the byte count from reaching zero, the master decides how many bytes it reads
+        SSP1_I2C_CNT = 0xFF;
+    }
+
+    // PCIF: Stop Condition Interrupt Flag bit
+    if(SSP1_I2C_PIRbits.PCIF == 1)
+    {
+#ifdef SSP1_I2C_SLAVE_FLAG_DEFER_END
+        // leave SSP1_I2C_slave_read and SSP1_I2C_slave_end to SSP1_I2C_slave_run_deferred() in the main loop
+        __SSP1_I2C_slave_end_pending = 1;
+#else
+        if((__SSP1_I2C_slave_address & 0b1) == 0) // 0: Write (master wrote, slave has read)
+        {
+            // all the bytes have been received, now we trigger the read function
+            SSP1_I2C_slave_read(__SSP1_I2C_slave_buffer_data, __SSP1_I2C_slave_buffer_index);
+        }
+
+        SSP1_I2C_slave_end();
+#endif /* SSP1_I2C_SLAVE_FLAG_DEFER_END */
+
+        // stop writing to master
+        SSP1_I2C_TXIE = 0;
+
+        // discard the byte that was prepared in advance, but never read by the master
+        SSP1_I2C_STAT1bits.CLRBF = 1;
+
+        SSP1_I2C_PIRbits.PCIF = 0;
+    }
+}
+
+#endif /* SSP1_I2C_MODULE */
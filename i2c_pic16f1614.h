@@ -7,13 +7,32 @@
 // indicate that the SSP1 module is available:
 #define SSP1_I2C
 
+// indicate that SSP1 is an MSSP module (core state machine: i2c_mssp.c)
+#define SSP1_I2C_MSSP
+
 // specify a suitable buffer length, depending on available PIC memory
 #ifndef SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH
 #define SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH 256
 #endif
 
+
+// MSSP1 registers (pp. 308-312)
+#define SSP1_I2C_BUF        SSP1BUF
+#define SSP1_I2C_ADD        SSP1ADD
+#define SSP1_I2C_MSK        SSP1MSK
+#define SSP1_I2C_STATbits   SSP1STATbits
+#define SSP1_I2C_CON1bits   SSP1CON1bits
+#define SSP1_I2C_CON2bits   SSP1CON2bits
+#define SSP1_I2C_CON3bits   SSP1CON3bits
+
+// MSSP1 interrupt enable and flag bits (pp. 98-104)
+#define SSP1_I2C_IE         PIE1bits.SSP1IE
+#define SSP1_I2C_IF         PIR1bits.SSP1IF
+#define SSP1_I2C_BCLIE      PIE2bits.BCL1IE
+#define SSP1_I2C_BCLIF      PIR2bits.BCL1IF
+
+
 #include "i2c.h"
 
 
 #endif	/* I2C_PIC16F1614_H */
-
@@ -0,0 +1,53 @@
+// Device: PIC18F27K42
+// Datasheet: DS40001919 (PIC18(L)F26/27/45/46/47/55/56/57K42)
+
+#ifndef I2C_PIC18F27K42_H
+#define	I2C_PIC18F27K42_H
+
+// indicate that the SSP1 module is available (the library API keeps the SSP1 prefix, the module is named I2C1 in the datasheet):
+#define SSP1_I2C
+
+// indicate that SSP1 is a dedicated I2C module (core state machine: i2c_module.c)
+#define SSP1_I2C_MODULE
+
+// specify a suitable buffer length, depending on available PIC memory
+#ifndef SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH
+#define SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH 256
+#endif
+
+
+// I2C1 registers (chapter 33, I2C Module)
+#define SSP1_I2C_RXB        I2C1RXB
+#define SSP1_I2C_TXB        I2C1TXB
+#define SSP1_I2C_CNT        I2C1CNT
+#define SSP1_I2C_ADB0       I2C1ADB0
+#define SSP1_I2C_ADR0       I2C1ADR0
+#define SSP1_I2C_ADR1       I2C1ADR1
+#define SSP1_I2C_ADR2       I2C1ADR2
+#define SSP1_I2C_ADR3       I2C1ADR3
+#define SSP1_I2C_CON0bits   I2C1CON0bits
+#define SSP1_I2C_CON1bits   I2C1CON1bits
+#define SSP1_I2C_CON2bits   I2C1CON2bits
+#define SSP1_I2C_STAT0bits  I2C1STAT0bits
+#define SSP1_I2C_STAT1bits  I2C1STAT1bits
+#define SSP1_I2C_PIR        I2C1PIR
+#define SSP1_I2C_PIRbits    I2C1PIRbits
+#define SSP1_I2C_PIEbits    I2C1PIEbits
+#define SSP1_I2C_ERR        I2C1ERR
+#define SSP1_I2C_ERRbits    I2C1ERRbits
+
+// I2C1 interrupt enable and flag bits (PIE3/PIR3)
+#define SSP1_I2C_IE         PIE3bits.I2C1IE
+#define SSP1_I2C_IF         PIR3bits.I2C1IF
+#define SSP1_I2C_EIE        PIE3bits.I2C1EIE
+#define SSP1_I2C_EIF        PIR3bits.I2C1EIF
+#define SSP1_I2C_RXIE       PIE3bits.I2C1RXIE
+#define SSP1_I2C_RXIF       PIR3bits.I2C1RXIF
+#define SSP1_I2C_TXIE       PIE3bits.I2C1TXIE
+#define SSP1_I2C_TXIF       PIR3bits.I2C1TXIF
+
+
+#include "i2c.h"
+
+
+#endif	/* I2C_PIC18F27K42_H */
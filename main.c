@@ -5,7 +5,7 @@
 #include <xc.h>
 #include <pic16f1614.h>
 
-#include "i2c_pic16f1614.h"
+#include "i2c_device.h"
 
 
 // do not use device addresses below 8 or above 119 (these are reserved)
@@ -186,8 +186,9 @@ void __interrupt() interrupt_handler(void)
     if(INTCONbits.PEIE == 1)
     {
 #ifdef USE_INTERRUPT
-        // I2C_slave_handle_interrupt() calls either I2C_slave_read, I2C_slave_write, or nothing (in case of error etc.)
-        SSP1_I2C_slave_handle_interrupt();
+        // SSP1_I2C_slave_dispatch_interrupt() only calls SSP1_I2C_slave_handle_interrupt() if SSP1IF or BCL1IF is set (and enabled),
+        // so interrupts of other peripherals (handled here as well) do not pay for the I2C status decode
+        SSP1_I2C_slave_dispatch_interrupt();
 #endif /* USE_INTERRUPT */
     }
 }
@@ -250,6 +251,11 @@ void main(void)
         SSP1_I2C_slave_handle_interrupt();
         
 #endif /* USE_INTERRUPT */
+        
+#ifdef SSP1_I2C_SLAVE_FLAG_DEFER_END
+        // Call SSP1_I2C_slave_read and SSP1_I2C_slave_end after a stopbit (outside of the interrupt handler)
+        SSP1_I2C_slave_run_deferred();
+#endif /* SSP1_I2C_SLAVE_FLAG_DEFER_END */
     }
     
     
@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=main.c i2c_pic16f1614.c i2c.c
+SOURCEFILES_QUOTED_IF_SPACED=main.c i2c_mssp.c i2c_module.c i2c.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/main.p1 ${OBJECTDIR}/i2c_pic16f1614.p1 ${OBJECTDIR}/i2c.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/main.p1.d ${OBJECTDIR}/i2c_pic16f1614.p1.d ${OBJECTDIR}/i2c.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/main.p1 ${OBJECTDIR}/i2c_mssp.p1 ${OBJECTDIR}/i2c_module.p1 ${OBJECTDIR}/i2c.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/main.p1.d ${OBJECTDIR}/i2c_mssp.p1.d ${OBJECTDIR}/i2c_module.p1.d ${OBJECTDIR}/i2c.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/main.p1 ${OBJECTDIR}/i2c_pic16f1614.p1 ${OBJECTDIR}/i2c.p1
+OBJECTFILES=${OBJECTDIR}/main.p1 ${OBJECTDIR}/i2c_mssp.p1 ${OBJECTDIR}/i2c_module.p1 ${OBJECTDIR}/i2c.p1
 
 # Source Files
-SOURCEFILES=main.c i2c_pic16f1614.c i2c.c
+SOURCEFILES=main.c i2c_mssp.c i2c_module.c i2c.c
 
 
 
@@ -102,13 +102,21 @@ ${OBJECTDIR}/main.p1: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/main.d ${OBJECTDIR}/main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
-${OBJECTDIR}/i2c_pic16f1614.p1: i2c_pic16f1614.c  nbproject/Makefile-${CND_CONF}.mk 
+${OBJECTDIR}/i2c_mssp.p1: i2c_mssp.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}" 
-	@${RM} ${OBJECTDIR}/i2c_pic16f1614.p1.d 
-	@${RM} ${OBJECTDIR}/i2c_pic16f1614.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fno-short-double -fno-short-float -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/i2c_pic16f1614.p1 i2c_pic16f1614.c 
-	@-${MV} ${OBJECTDIR}/i2c_pic16f1614.d ${OBJECTDIR}/i2c_pic16f1614.p1.d 
-	@${FIXDEPS} ${OBJECTDIR}/i2c_pic16f1614.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	@${RM} ${OBJECTDIR}/i2c_mssp.p1.d 
+	@${RM} ${OBJECTDIR}/i2c_mssp.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fno-short-double -fno-short-float -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/i2c_mssp.p1 i2c_mssp.c 
+	@-${MV} ${OBJECTDIR}/i2c_mssp.d ${OBJECTDIR}/i2c_mssp.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/i2c_mssp.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/i2c_module.p1: i2c_module.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/i2c_module.p1.d 
+	@${RM} ${OBJECTDIR}/i2c_module.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fno-short-double -fno-short-float -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/i2c_module.p1 i2c_module.c 
+	@-${MV} ${OBJECTDIR}/i2c_module.d ${OBJECTDIR}/i2c_module.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/i2c_module.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
 ${OBJECTDIR}/i2c.p1: i2c.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}" 
@@ -127,13 +135,21 @@ ${OBJECTDIR}/main.p1: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/main.d ${OBJECTDIR}/main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
-${OBJECTDIR}/i2c_pic16f1614.p1: i2c_pic16f1614.c  nbproject/Makefile-${CND_CONF}.mk 
+${OBJECTDIR}/i2c_mssp.p1: i2c_mssp.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/i2c_mssp.p1.d 
+	@${RM} ${OBJECTDIR}/i2c_mssp.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fno-short-double -fno-short-float -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/i2c_mssp.p1 i2c_mssp.c 
+	@-${MV} ${OBJECTDIR}/i2c_mssp.d ${OBJECTDIR}/i2c_mssp.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/i2c_mssp.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/i2c_module.p1: i2c_module.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}" 
-	@${RM} ${OBJECTDIR}/i2c_pic16f1614.p1.d 
-	@${RM} ${OBJECTDIR}/i2c_pic16f1614.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fno-short-double -fno-short-float -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/i2c_pic16f1614.p1 i2c_pic16f1614.c 
-	@-${MV} ${OBJECTDIR}/i2c_pic16f1614.d ${OBJECTDIR}/i2c_pic16f1614.p1.d 
-	@${FIXDEPS} ${OBJECTDIR}/i2c_pic16f1614.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	@${RM} ${OBJECTDIR}/i2c_module.p1.d 
+	@${RM} ${OBJECTDIR}/i2c_module.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fno-short-double -fno-short-float -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/i2c_module.p1 i2c_module.c 
+	@-${MV} ${OBJECTDIR}/i2c_module.d ${OBJECTDIR}/i2c_module.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/i2c_module.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
 ${OBJECTDIR}/i2c.p1: i2c.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}" 
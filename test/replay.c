@@ -0,0 +1,720 @@
+// Replays a recorded bus trace through the slave state machine, and prints the callbacks and the bytes written to the master
+//
+// Usage: replay <trace.csv>
+//
+// The trace is in the CSV format of a logic analyser export, one bus event per line: time,event,data,ack
+//  - START, RESTART: start condition
+//  - ADDR: address byte (including the R/W bit), ack is the acknowledge of the slave
+//  - DATA: data byte, ack is the acknowledge of the slave (master writes) or of the master (master reads)
+//  - STOP: stop condition
+//  - COLLISION: bus collision detected by the slave
+//  - OVERFLOW: data byte written by the master while the previous byte was not read yet (MSSP only: sets SSPOV)
+//  - OTHER: interrupt of another peripheral (the interrupt handler calls SSP1_I2C_slave_dispatch_interrupt, as in main.c)
+//  - MAIN: the main loop runs (calls SSP1_I2C_slave_run_deferred, if SSP1_I2C_SLAVE_FLAG_DEFER_END is defined)
+//  - MAIN_SUSPEND, MAIN_RESUME: the main loop runs, but its first callback is interrupted by the events in between
+// Empty lines, lines starting with '#', and the header line are ignored.
+//
+// The registers are mapped by the stub descriptor header (see I2C_DEVICE_HEADER in i2c_device.h), and the bus model below
+// sets the flags as the module would, then enters the interrupt handler as long as an enabled interrupt is pending.
+// The interrupt handler calls SSP1_I2C_slave_dispatch_interrupt (as in main.c).
+// After every event that entered the interrupt handler, the cost of the event is printed: the number of times the handler
+// was entered, and the number of callbacks it made (a change in either shows up as a difference with the golden file).
+// Not modelled: start condition interrupts, and the interrupt upon a NACK from the master (both are not used by the core).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "i2c_device.h"
+
+// the address of the slave (0x30 for a write, 0x31 for a read)
+#define REPLAY_SLAVE_ADDRESS 0x18
+
+// maximum number of times the interrupt handler is entered for a single bus event, before the interrupt is considered stuck
+#define REPLAY_MAX_INTERRUPTS 8
+
+// the slave has matched its address since the last start condition
+unsigned char replay_addressed = 0;
+
+// the master reads from the slave (R/W bit of the address)
+unsigned char replay_reading = 0;
+
+// cost of the current event: number of times the interrupt handler was entered, and number of callbacks
+unsigned int replay_interrupts = 0;
+unsigned int replay_callbacks = 0;
+
+// the trace that is replayed, and the number of the current line
+FILE* replay_file;
+const char* replay_path;
+int replay_number = 0;
+
+// the main loop is interrupted in its next callback (MAIN_SUSPEND)
+unsigned char replay_suspend = 0;
+
+void replay_run(const char* until);
+
+// replay the events up to MAIN_RESUME, if the main loop is to be interrupted here
+void replay_main_interrupted(void)
+{
+    unsigned int interrupts = replay_interrupts;
+    unsigned int callbacks = replay_callbacks;
+
+    if(replay_suspend == 0)
+    {
+        return;
+    }
+    replay_suspend = 0;
+
+    replay_run("MAIN_RESUME");
+
+    replay_interrupts = interrupts;
+    replay_callbacks = callbacks;
+}
+
+
+// callbacks, these print what they are called with
+
+void SSP1_I2C_slave_begin(unsigned char address)
+{
+    ++replay_callbacks;
+    printf("begin 0x%02X\n", address);
+}
+
+void SSP1_I2C_slave_read(unsigned char* data, size_t length)
+{
+    size_t i;
+
+    ++replay_callbacks;
+    replay_main_interrupted();
+
+    if(length > SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH)
+    {
+        printf("error: read %u bytes, buffer is only %u bytes\n", (unsigned) length, (unsigned) SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH);
+        return;
+    }
+
+    printf("read %u:", (unsigned) length);
+    for(i = 0; i < length; ++i)
+    {
+        printf(" 0x%02X", data[i]);
+    }
+    printf("\n");
+}
+
+void SSP1_I2C_slave_write(unsigned char* data)
+{
+    size_t i;
+
+    ++replay_callbacks;
+
+    // the first byte is what the master wrote before a repeated start (e.g. a register number)
+    printf("write (data[0] = 0x%02X)\n", data[0]);
+
+    for(i = 0; i < SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH; ++i)
+    {
+        data[i] = (unsigned char) (0xA0 + i);
+    }
+}
+
+void SSP1_I2C_slave_end(void)
+{
+    ++replay_callbacks;
+    replay_main_interrupted();
+
+    printf("end\n");
+}
+
+
+#ifdef SSP1_I2C_MSSP
+
+unsigned char stub_ssp1buf;
+unsigned char stub_ssp1add;
+unsigned char stub_ssp1msk;
+struct stub_mssp_stat stub_ssp1stat;
+struct stub_mssp_con stub_ssp1con1;
+struct stub_mssp_con stub_ssp1con2;
+struct stub_mssp_con stub_ssp1con3;
+unsigned char stub_ssp1ie;
+unsigned char stub_ssp1if;
+unsigned char stub_bcl1ie;
+unsigned char stub_bcl1if;
+
+int replay_interrupt_requested(void)
+{
+    return (stub_ssp1if == 1 && stub_ssp1ie == 1) || (stub_bcl1if == 1 && stub_bcl1ie == 1);
+}
+
+int replay_interrupt_masked(void)
+{
+    return (stub_ssp1if == 1 && stub_ssp1ie == 0) || (stub_bcl1if == 1 && stub_bcl1ie == 0);
+}
+
+int replay_clock_held(void)
+{
+    return stub_ssp1con1.CKP == 0;
+}
+
+void replay_check_state(void)
+{
+    if(stub_ssp1con1.CKP == 0)
+    {
+        printf("error: clock is held (CKP = 0)\n");
+    }
+    if(stub_ssp1con1.SSPOV == 1)
+    {
+        printf("error: receive overflow is not cleared (SSPOV = 1)\n");
+    }
+}
+
+void replay_init(void)
+{
+}
+
+void replay_start(void)
+{
+    stub_ssp1stat.S = 1;
+    stub_ssp1stat.P = 0;
+}
+
+int replay_address(unsigned char address)
+{
+    if((address >> 1) != (stub_ssp1add >> 1))
+    {
+        return 0;
+    }
+
+    stub_ssp1stat.D_nA = 0;
+    stub_ssp1stat.R_nW = address & 0b1;
+    stub_ssp1buf = address;
+    stub_ssp1if = 1;
+
+    // clock stretching (SEN = 1): the clock is held after the address, until CKP is set
+    stub_ssp1con1.CKP = !stub_ssp1con2.SEN;
+    return 1;
+}
+
+// master writes a byte, returns the acknowledge of the slave (0: ACK)
+int replay_write(unsigned char data)
+{
+    // no byte is received while the overflow is not cleared
+    if(stub_ssp1con1.SSPOV == 1)
+    {
+        return 1;
+    }
+
+    stub_ssp1stat.D_nA = 1;
+    stub_ssp1stat.R_nW = 0;
+    stub_ssp1buf = data;
+    stub_ssp1if = 1;
+    stub_ssp1con1.CKP = !stub_ssp1con2.SEN;
+    return 0;
+}
+
+// master reads a byte, returns 0 if the slave could not write a byte
+int replay_read(unsigned char* data, int ack)
+{
+    *data = stub_ssp1buf;
+
+    if(ack == 0)
+    {
+        // the master requests another byte
+        stub_ssp1stat.D_nA = 1;
+        stub_ssp1stat.R_nW = 1;
+        stub_ssp1if = 1;
+        stub_ssp1con1.CKP = !stub_ssp1con2.SEN;
+    }
+    return 1;
+}
+
+void replay_stop(void)
+{
+    stub_ssp1stat.S = 0;
+    stub_ssp1stat.P = 1;
+    stub_ssp1if = stub_ssp1con3.PCIE;
+}
+
+void replay_collision(void)
+{
+    stub_ssp1stat.S = 0;
+    stub_bcl1if = stub_ssp1con3.SBCDE;
+}
+
+// master writes a byte while SSP1BUF is still full: the byte is lost and not acknowledged, returns the acknowledge of the slave
+int replay_overflow(void)
+{
+    stub_ssp1stat.D_nA = 1;
+    stub_ssp1stat.R_nW = 0;
+    stub_ssp1con1.SSPOV = 1;
+    stub_ssp1if = 1;
+    stub_ssp1con1.CKP = !stub_ssp1con2.SEN;
+    return 1;
+}
+
+#endif /* SSP1_I2C_MSSP */
+
+
+#ifdef SSP1_I2C_MODULE
+
+unsigned char stub_i2c1cnt;
+unsigned char stub_i2c1adb0;
+unsigned char stub_i2c1adr0;
+unsigned char stub_i2c1adr1;
+unsigned char stub_i2c1adr2;
+unsigned char stub_i2c1adr3;
+struct stub_module_con0 stub_i2c1con0;
+struct stub_module_con1 stub_i2c1con1;
+struct stub_module_con2 stub_i2c1con2;
+struct stub_module_stat0 stub_i2c1stat0;
+struct stub_module_stat1 stub_i2c1stat1;
+union stub_module_pir stub_i2c1pir;
+struct stub_module_pie stub_i2c1pie;
+union stub_module_err stub_i2c1err;
+unsigned char stub_i2c1ie;
+unsigned char stub_i2c1eie;
+unsigned char stub_i2c1rxie;
+unsigned char stub_i2c1txie;
+
+unsigned char stub_i2c1rxb_value;
+unsigned char stub_i2c1txb_value;
+unsigned char stub_i2c1txb_discard;
+unsigned char stub_i2c1flag;
+
+// CLRBF empties both buffers, and reads back as 0
+void stub_i2c1clrbf(void)
+{
+    if(stub_i2c1stat1.CLRBF == 1)
+    {
+        stub_i2c1stat1.CLRBF = 0;
+        stub_i2c1stat1.RXBF = 0;
+        stub_i2c1stat1.TXBE = 1;
+    }
+}
+
+// reading RXB clears RXBF
+unsigned char* stub_i2c1rxb(void)
+{
+    stub_i2c1clrbf();
+    stub_i2c1stat1.RXBF = 0;
+    return &stub_i2c1rxb_value;
+}
+
+// writing TXB clears TXBE, a write while TXB is full is discarded (TXWE in hardware)
+unsigned char* stub_i2c1txb(void)
+{
+    stub_i2c1clrbf();
+    if(stub_i2c1stat1.TXBE == 0)
+    {
+        printf("error: TXB written while full\n");
+        return &stub_i2c1txb_discard;
+    }
+
+    stub_i2c1stat1.TXBE = 0;
+    return &stub_i2c1txb_value;
+}
+
+// the flags below are read-only in hardware, writes are discarded
+
+unsigned char* stub_i2c1if(void)
+{
+    stub_i2c1flag = (stub_i2c1pir.bits.ADRIF == 1 && stub_i2c1pie.ADRIE == 1) || (stub_i2c1pir.bits.PCIF == 1 && stub_i2c1pie.PCIE == 1);
+    return &stub_i2c1flag;
+}
+
+unsigned char* stub_i2c1eif(void)
+{
+    stub_i2c1flag = stub_i2c1err.bits.BCLIF == 1 && stub_i2c1err.bits.BCLIE == 1;
+    return &stub_i2c1flag;
+}
+
+unsigned char* stub_i2c1rxif(void)
+{
+    stub_i2c1clrbf();
+    stub_i2c1flag = stub_i2c1stat1.RXBF;
+    return &stub_i2c1flag;
+}
+
+// TXIF is only set while the byte count is not zero
+unsigned char* stub_i2c1txif(void)
+{
+    stub_i2c1clrbf();
+    stub_i2c1flag = stub_i2c1stat1.TXBE == 1 && stub_i2c1cnt != 0;
+    return &stub_i2c1flag;
+}
+
+int replay_interrupt_requested(void)
+{
+    return (*stub_i2c1if() == 1 && stub_i2c1ie == 1)
+        || (*stub_i2c1eif() == 1 && stub_i2c1eie == 1)
+        || (*stub_i2c1rxif() == 1 && stub_i2c1rxie == 1)
+        || (*stub_i2c1txif() == 1 && stub_i2c1txie == 1);
+}
+
+// TXIF is left out, it is set whenever TXB is empty (and TXIE is only enabled while the master reads)
+int replay_interrupt_masked(void)
+{
+    return (*stub_i2c1if() == 1 && stub_i2c1ie == 0)
+        || (*stub_i2c1eif() == 1 && stub_i2c1eie == 0)
+        || (*stub_i2c1rxif() == 1 && stub_i2c1rxie == 0);
+}
+
+int replay_clock_held(void)
+{
+    return stub_i2c1con0.CSTR == 1;
+}
+
+void replay_check_state(void)
+{
+    if(stub_i2c1con0.CSTR == 1)
+    {
+        printf("error: clock is held (CSTR = 1)\n");
+    }
+}
+
+void replay_init(void)
+{
+    stub_i2c1stat1.TXBE = 1;
+}
+
+void replay_start(void)
+{
+}
+
+int replay_address(unsigned char address)
+{
+    if((address >> 1) != (stub_i2c1adr0 >> 1))
+    {
+        return 0;
+    }
+
+    stub_i2c1adb0 = address;
+    stub_i2c1stat0.R = address & 0b1;
+    stub_i2c1stat0.SMA = 1;
+    stub_i2c1pir.bits.ADRIF = 1;
+
+    // the clock is held after the address, until CSTR is cleared
+    stub_i2c1con0.CSTR = stub_i2c1pie.ADRIE;
+    return 1;
+}
+
+// master writes a byte, returns the acknowledge of the slave (0: ACK)
+int replay_write(unsigned char data)
+{
+    int ack;
+
+    stub_i2c1clrbf();
+    if(stub_i2c1stat1.RXBF == 1)
+    {
+        printf("error: receive buffer overflow (RXB was not read)\n");
+    }
+
+    // the acknowledge is ACKDT, or ACKCNT once the byte count has reached zero
+    ack = stub_i2c1cnt == 0 ? stub_i2c1con1.ACKCNT : stub_i2c1con1.ACKDT;
+    if(stub_i2c1cnt != 0)
+    {
+        --stub_i2c1cnt;
+    }
+
+    stub_i2c1rxb_value = data;
+    stub_i2c1stat1.RXBF = 1;
+    return ack;
+}
+
+// master reads a byte, returns 0 if the slave could not write a byte
+int replay_read(unsigned char* data, int ack)
+{
+    (void) ack; // the next byte is requested from TXB as soon as this byte is being shifted out
+
+    stub_i2c1clrbf();
+    if(stub_i2c1stat1.TXBE == 1)
+    {
+        return 0;
+    }
+
+    *data = stub_i2c1txb_value;
+    stub_i2c1stat1.TXBE = 1;
+    if(stub_i2c1cnt != 0)
+    {
+        --stub_i2c1cnt;
+    }
+    return 1;
+}
+
+void replay_stop(void)
+{
+    stub_i2c1stat0.SMA = 0;
+    stub_i2c1pir.bits.PCIF = 1;
+}
+
+void replay_collision(void)
+{
+    stub_i2c1stat0.SMA = 0;
+    stub_i2c1err.bits.BCLIF = 1;
+}
+
+#endif /* SSP1_I2C_MODULE */
+
+
+// enter the interrupt handler as long as an enabled interrupt is pending (as the hardware would)
+void replay_interrupt(void)
+{
+    int count = 0;
+
+    while(replay_interrupt_requested() && count < REPLAY_MAX_INTERRUPTS)
+    {
+        replay_interrupts += SSP1_I2C_slave_dispatch_interrupt();
+        ++count;
+    }
+
+    if(replay_interrupt_requested())
+    {
+        printf("error: interrupt is still pending after %d calls\n", REPLAY_MAX_INTERRUPTS);
+    }
+
+    // the interrupt is handled as soon as it is enabled again, until then the bus is stretched
+    if(replay_interrupt_masked())
+    {
+        printf("stretch (interrupt is masked)\n");
+        return;
+    }
+
+    replay_check_state();
+}
+
+// parse "0x30" or "48", returns -1 on error
+int replay_parse_byte(const char* text)
+{
+    char* end;
+    long value = strtol(text, &end, 0);
+
+    if(end == text || *end != '\0' || value < 0 || value > 0xFF)
+    {
+        return -1;
+    }
+    return (int) value;
+}
+
+// parse "ACK" (0) or "NACK" (1), returns -1 on error
+int replay_parse_ack(const char* text)
+{
+    if(strcmp(text, "ACK") == 0)
+    {
+        return 0;
+    }
+    if(strcmp(text, "NACK") == 0)
+    {
+        return 1;
+    }
+    return -1;
+}
+
+// split a CSV line into (at most) `count` fields, missing fields are empty
+void replay_split(char* line, char** fields, int count)
+{
+    int i;
+
+    for(i = 0; i < count; ++i)
+    {
+        fields[i] = line;
+        line += strcspn(line, ",\r\n");
+
+        if(*line == ',')
+        {
+            *line++ = '\0';
+        }
+        else
+        {
+            *line = '\0';
+        }
+    }
+}
+
+// replay the events of the trace, up to the event `until` (or the end of the trace if NULL)
+void replay_run(const char* until)
+{
+    char line[256];
+
+    while(fgets(line, sizeof(line), replay_file) != NULL)
+    {
+        char* fields[4];
+        const char* event;
+        int data;
+        int ack;
+
+        ++replay_number;
+        if(line[0] == '#' || line[0] == '\r' || line[0] == '\n' || strncmp(line, "time,", 5) == 0)
+        {
+            continue;
+        }
+
+        replay_split(line, fields, 4);
+        event = fields[1];
+        data = replay_parse_byte(fields[2]);
+        ack = replay_parse_ack(fields[3]);
+
+        if(until != NULL && strcmp(event, until) == 0)
+        {
+            return;
+        }
+
+        replay_interrupts = 0;
+        replay_callbacks = 0;
+
+        if(strcmp(event, "START") == 0 || strcmp(event, "RESTART") == 0)
+        {
+            replay_addressed = 0;
+            replay_start();
+        }
+        else if(strcmp(event, "ADDR") == 0 && data >= 0 && ack >= 0)
+        {
+            replay_addressed = replay_address((unsigned char) data);
+            replay_reading = replay_addressed && (data & 0b1);
+
+            if(replay_addressed != (ack == 0))
+            {
+                printf("error: line %d: slave %s the address, trace has %s\n", replay_number, replay_addressed ? "ACKs" : "NACKs", fields[3]);
+            }
+            if(replay_addressed)
+            {
+                replay_interrupt();
+            }
+        }
+        else if(strcmp(event, "DATA") == 0 && data >= 0 && ack >= 0)
+        {
+            if(!replay_addressed)
+            {
+                continue;
+            }
+
+            if(replay_clock_held())
+            {
+                printf("error: line %d: master continues while the clock is held\n", replay_number);
+            }
+
+            if(replay_reading)
+            {
+                unsigned char byte;
+
+                // the master reads a byte, and acknowledges it
+                if(!replay_read(&byte, ack))
+                {
+                    printf("error: line %d: master read stalled, no byte to write\n", replay_number);
+                    replay_addressed = 0;
+                    continue;
+                }
+
+                printf("tx 0x%02X\n", byte);
+                if(byte != data)
+                {
+                    printf("error: line %d: trace has 0x%02X\n", replay_number, data);
+                }
+            }
+            else
+            {
+                // the master writes a byte, and the slave acknowledges it
+                int slave_ack = replay_write((unsigned char) data);
+
+                if(slave_ack != ack)
+                {
+                    printf("error: line %d: slave %s the byte, trace has %s\n", replay_number, slave_ack ? "NACKs" : "ACKs", fields[3]);
+                }
+            }
+
+            replay_interrupt();
+        }
+        else if(strcmp(event, "STOP") == 0)
+        {
+            replay_addressed = 0;
+            replay_stop();
+            replay_interrupt();
+        }
+        else if(strcmp(event, "COLLISION") == 0)
+        {
+            replay_addressed = 0;
+            replay_collision();
+            replay_interrupt();
+        }
+        else if(strcmp(event, "OTHER") == 0)
+        {
+            // the interrupt handler is entered for another peripheral, and calls SSP1_I2C_slave_dispatch_interrupt as well
+            replay_interrupts += SSP1_I2C_slave_dispatch_interrupt();
+        }
+        else if(strcmp(event, "MAIN") == 0 || strcmp(event, "MAIN_SUSPEND") == 0)
+        {
+            printf("main\n");
+            replay_suspend = strcmp(event, "MAIN_SUSPEND") == 0;
+#ifdef SSP1_I2C_SLAVE_FLAG_DEFER_END
+            SSP1_I2C_slave_run_deferred();
+#endif /* SSP1_I2C_SLAVE_FLAG_DEFER_END */
+
+            if(replay_suspend)
+            {
+                fprintf(stderr, "%s:%d: the main loop made no callback to suspend\n", replay_path, replay_number);
+                exit(2);
+            }
+
+            // interrupts that were masked by the main loop are handled now
+            replay_interrupt();
+        }
+#ifdef SSP1_I2C_MSSP
+        else if(strcmp(event, "OVERFLOW") == 0 && data >= 0 && ack >= 0)
+        {
+            int slave_ack;
+
+            if(!replay_addressed || replay_reading)
+            {
+                continue;
+            }
+
+            slave_ack = replay_overflow();
+            if(slave_ack != ack)
+            {
+                printf("error: line %d: slave %s the byte, trace has %s\n", replay_number, slave_ack ? "NACKs" : "ACKs", fields[3]);
+            }
+
+            replay_interrupt();
+        }
+#endif /* SSP1_I2C_MSSP */
+        else
+        {
+            fprintf(stderr, "%s:%d: invalid event\n", replay_path, replay_number);
+            exit(2);
+        }
+
+        if(replay_interrupts > 0 || replay_callbacks > 0)
+        {
+            printf("cost %s: interrupts=%u callbacks=%u\n", event, replay_interrupts, replay_callbacks);
+        }
+    }
+
+
+    if(until != NULL)
+    {
+        fprintf(stderr, "%s: %s is missing\n", replay_path, until);
+        exit(2);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if(argc != 2)
+    {
+        fprintf(stderr, "usage: %s <trace.csv>\n", argv[0]);
+        return 2;
+    }
+
+    replay_path = argv[1];
+    replay_file = fopen(replay_path, "r");
+    if(replay_file == NULL)
+    {
+        perror(replay_path);
+        return 2;
+    }
+
+    SSP1_I2C_slave_init(REPLAY_SLAVE_ADDRESS);
+    replay_init();
+
+    replay_run(NULL);
+
+    fclose(replay_file);
+    return 0;
+}
@@ -0,0 +1,169 @@
+// Stub descriptor header for the I2C module core (i2c_module.c)
+// The registers are plain variables, which are driven by the bus model in replay.c
+// Registers with side effects (RXB, TXB) and flags that are derived by the hardware (I2C1IF, I2C1EIF, I2C1RXIF, I2C1TXIF)
+// are accessed through functions, which return a pointer, so that they can still be assigned to
+
+#ifndef STUB_MODULE_H
+#define	STUB_MODULE_H
+
+// indicate that the SSP1 module is available:
+#define SSP1_I2C
+
+// indicate that SSP1 is a dedicated I2C module (core state machine: i2c_module.c)
+#define SSP1_I2C_MODULE
+
+// a small buffer, so that the traces can overflow it
+#define SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH 4
+
+
+struct stub_module_con0
+{
+    unsigned char EN:1;
+    unsigned char RSEN:1;
+    unsigned char S:1;
+    unsigned char CSTR:1;
+    unsigned char MDR:1;
+    unsigned char MODE:3;
+};
+
+struct stub_module_con1
+{
+    unsigned char ACKCNT:1;
+    unsigned char ACKDT:1;
+    unsigned char ACKSTAT:1;
+    unsigned char ACKT:1;
+    unsigned char RXO:1;
+    unsigned char TXU:1;
+    unsigned char CSD:1;
+};
+
+struct stub_module_con2
+{
+    unsigned char ACNT:1;
+    unsigned char GCEN:1;
+    unsigned char FME:1;
+    unsigned char ABD:1;
+    unsigned char SDAHT:2;
+    unsigned char BFRET:2;
+};
+
+struct stub_module_stat0
+{
+    unsigned char BFRE:1;
+    unsigned char SMA:1;
+    unsigned char MMA:1;
+    unsigned char R:1;
+    unsigned char D:1;
+};
+
+struct stub_module_stat1
+{
+    unsigned char TXWE:1;
+    unsigned char TXBE:1;
+    unsigned char RXRE:1;
+    unsigned char CLRBF:1;
+    unsigned char RXBF:1;
+};
+
+union stub_module_pir
+{
+    unsigned char reg;
+    struct
+    {
+        unsigned char SCIF:1;
+        unsigned char RSCIF:1;
+        unsigned char PCIF:1;
+        unsigned char ADRIF:1;
+        unsigned char WRIF:1;
+        unsigned char ACKTIF:1;
+        unsigned char CNTIF:1;
+    } bits;
+};
+
+struct stub_module_pie
+{
+    unsigned char SCIE:1;
+    unsigned char RSCIE:1;
+    unsigned char PCIE:1;
+    unsigned char ADRIE:1;
+    unsigned char WRIE:1;
+    unsigned char ACKTIE:1;
+    unsigned char CNTIE:1;
+};
+
+union stub_module_err
+{
+    unsigned char reg;
+    struct
+    {
+        unsigned char NACKIE:1;
+        unsigned char BCLIE:1;
+        unsigned char BTOIE:1;
+        unsigned char NACKIF:1;
+        unsigned char BCLIF:1;
+        unsigned char BTOIF:1;
+    } bits;
+};
+
+extern unsigned char stub_i2c1cnt;
+extern unsigned char stub_i2c1adb0;
+extern unsigned char stub_i2c1adr0;
+extern unsigned char stub_i2c1adr1;
+extern unsigned char stub_i2c1adr2;
+extern unsigned char stub_i2c1adr3;
+extern struct stub_module_con0 stub_i2c1con0;
+extern struct stub_module_con1 stub_i2c1con1;
+extern struct stub_module_con2 stub_i2c1con2;
+extern struct stub_module_stat0 stub_i2c1stat0;
+extern struct stub_module_stat1 stub_i2c1stat1;
+extern union stub_module_pir stub_i2c1pir;
+extern struct stub_module_pie stub_i2c1pie;
+extern union stub_module_err stub_i2c1err;
+extern unsigned char stub_i2c1ie;
+extern unsigned char stub_i2c1eie;
+extern unsigned char stub_i2c1rxie;
+extern unsigned char stub_i2c1txie;
+
+unsigned char* stub_i2c1rxb(void);
+unsigned char* stub_i2c1txb(void);
+unsigned char* stub_i2c1if(void);
+unsigned char* stub_i2c1eif(void);
+unsigned char* stub_i2c1rxif(void);
+unsigned char* stub_i2c1txif(void);
+
+
+// I2C1 registers
+#define SSP1_I2C_RXB        (*stub_i2c1rxb())
+#define SSP1_I2C_TXB        (*stub_i2c1txb())
+#define SSP1_I2C_CNT        stub_i2c1cnt
+#define SSP1_I2C_ADB0       stub_i2c1adb0
+#define SSP1_I2C_ADR0       stub_i2c1adr0
+#define SSP1_I2C_ADR1       stub_i2c1adr1
+#define SSP1_I2C_ADR2       stub_i2c1adr2
+#define SSP1_I2C_ADR3       stub_i2c1adr3
+#define SSP1_I2C_CON0bits   stub_i2c1con0
+#define SSP1_I2C_CON1bits   stub_i2c1con1
+#define SSP1_I2C_CON2bits   stub_i2c1con2
+#define SSP1_I2C_STAT0bits  stub_i2c1stat0
+#define SSP1_I2C_STAT1bits  stub_i2c1stat1
+#define SSP1_I2C_PIR        stub_i2c1pir.reg
+#define SSP1_I2C_PIRbits    stub_i2c1pir.bits
+#define SSP1_I2C_PIEbits    stub_i2c1pie
+#define SSP1_I2C_ERR        stub_i2c1err.reg
+#define SSP1_I2C_ERRbits    stub_i2c1err.bits
+
+// I2C1 interrupt enable and flag bits
+#define SSP1_I2C_IE         stub_i2c1ie
+#define SSP1_I2C_IF         (*stub_i2c1if())
+#define SSP1_I2C_EIE        stub_i2c1eie
+#define SSP1_I2C_EIF        (*stub_i2c1eif())
+#define SSP1_I2C_RXIE       stub_i2c1rxie
+#define SSP1_I2C_RXIF       (*stub_i2c1rxif())
+#define SSP1_I2C_TXIE       stub_i2c1txie
+#define SSP1_I2C_TXIF       (*stub_i2c1txif())
+
+
+#include "i2c.h"
+
+
+#endif	/* STUB_MODULE_H */
@@ -0,0 +1,75 @@
+// Stub descriptor header for the MSSP core (i2c_mssp.c)
+// The registers are plain variables, which are driven by the bus model in replay.c
+
+#ifndef STUB_MSSP_H
+#define	STUB_MSSP_H
+
+// indicate that the SSP1 module is available:
+#define SSP1_I2C
+
+// indicate that SSP1 is an MSSP module (core state machine: i2c_mssp.c)
+#define SSP1_I2C_MSSP
+
+// a small buffer, so that the traces can overflow it
+#define SSP1_I2C_SLAVE_MAX_BUFFER_LENGTH 4
+
+
+struct stub_mssp_stat
+{
+    unsigned char SMP:1;
+    unsigned char CKE:1;
+    unsigned char D_nA:1;
+    unsigned char P:1;
+    unsigned char S:1;
+    unsigned char R_nW:1;
+    unsigned char BF:1;
+};
+
+// SSP1CON1, SSP1CON2 and SSP1CON3 share one layout, with the bits used by the core
+struct stub_mssp_con
+{
+    unsigned char WCOL:1;
+    unsigned char SSPOV:1;
+    unsigned char SSPEN:1;
+    unsigned char CKP:1;
+    unsigned char SSPM:4;
+    unsigned char SEN:1;
+    unsigned char PCIE:1;
+    unsigned char SCIE:1;
+    unsigned char SDAHT:1;
+    unsigned char SBCDE:1;
+};
+
+extern unsigned char stub_ssp1buf;
+extern unsigned char stub_ssp1add;
+extern unsigned char stub_ssp1msk;
+extern struct stub_mssp_stat stub_ssp1stat;
+extern struct stub_mssp_con stub_ssp1con1;
+extern struct stub_mssp_con stub_ssp1con2;
+extern struct stub_mssp_con stub_ssp1con3;
+extern unsigned char stub_ssp1ie;
+extern unsigned char stub_ssp1if;
+extern unsigned char stub_bcl1ie;
+extern unsigned char stub_bcl1if;
+
+
+// MSSP1 registers
+#define SSP1_I2C_BUF        stub_ssp1buf
+#define SSP1_I2C_ADD        stub_ssp1add
+#define SSP1_I2C_MSK        stub_ssp1msk
+#define SSP1_I2C_STATbits   stub_ssp1stat
+#define SSP1_I2C_CON1bits   stub_ssp1con1
+#define SSP1_I2C_CON2bits   stub_ssp1con2
+#define SSP1_I2C_CON3bits   stub_ssp1con3
+
+// MSSP1 interrupt enable and flag bits
+#define SSP1_I2C_IE         stub_ssp1ie
+#define SSP1_I2C_IF         stub_ssp1if
+#define SSP1_I2C_BCLIE      stub_bcl1ie
+#define SSP1_I2C_BCLIF      stub_bcl1if
+
+
+#include "i2c.h"
+
+
+#endif	/* STUB_MSSP_H */